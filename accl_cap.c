@@ -0,0 +1,231 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+#include <errno.h>
+#include <signal.h>
+
+#define PORT 65432
+#define BUFFER_SIZE 4096
+#define PRINT_INTERVAL 10 // Print status every 10 seconds
+#define MAX_RETRIES 5
+#define RETRY_DELAY 1000000 // 1 second in microseconds
+#define DEFAULT_HOST "192.168.40.61"
+#define CAPTURE_MAGIC "ACCLCAP2"
+
+/*
+ * Capture file layout (native byte order, same as the .bin chunks):
+ *   8 bytes   magic "ACCLCAP2"
+ *   then one record per recv():
+ *     double    arrival time (CLOCK_MONOTONIC, seconds), used for replay pacing
+ *     double    arrival wall-clock time (CLOCK_REALTIME, seconds)
+ *     uint32_t  payload length (at most BUFFER_SIZE)
+ *     payload   raw bytes exactly as received from port 65432
+ */
+
+volatile sig_atomic_t keep_running = 1;
+FILE *log_file = NULL;
+
+void signal_handler(int signum) {
+    keep_running = 0;
+}
+
+void log_message(const char *message) {
+    time_t now;
+    char timestamp[64];
+    time(&now);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", localtime(&now));
+    fprintf(stderr, "[%s] %s\n", timestamp, message);
+    if (log_file) {
+        fprintf(log_file, "[%s] %s\n", timestamp, message);
+        fflush(log_file);
+    }
+}
+
+void install_signal_handlers() {
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = signal_handler;
+    sigemptyset(&sa.sa_mask);
+    // No SA_RESTART, so a blocking recv() returns EINTR on Ctrl-C
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+}
+
+void create_log_file() {
+    char log_folder[256] = "logs";
+    char log_filename[512];
+    char full_path[768];
+    time_t now = time(NULL);
+    struct tm *t = localtime(&now);
+
+    mkdir(log_folder, 0777);
+
+    strftime(log_filename, sizeof(log_filename), "%Y-%m-%d_%H-%M-%S_accl_cap.log", t);
+    snprintf(full_path, sizeof(full_path), "%s/%s", log_folder, log_filename);
+
+    log_file = fopen(full_path, "w");
+    if (log_file == NULL) {
+        fprintf(stderr, "Error creating log file '%s': %s\n", full_path, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+}
+
+FILE* open_capture_file(const char *path) {
+    char default_path[256];
+
+    if (path == NULL) {
+        time_t t = time(NULL);
+        mkdir("captures", 0777);
+        strftime(default_path, sizeof(default_path), "captures/%Y-%m-%d_%H-%M-%S_accl.cap", localtime(&t));
+        path = default_path;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        char error_msg[512];
+        snprintf(error_msg, sizeof(error_msg), "Error opening capture file '%s': %s", path, strerror(errno));
+        log_message(error_msg);
+        exit(EXIT_FAILURE);
+    }
+    setvbuf(file, NULL, _IOFBF, 1 << 16);
+    if (fwrite(CAPTURE_MAGIC, 1, 8, file) != 8) {
+        char error_msg[512];
+        snprintf(error_msg, sizeof(error_msg), "Error writing capture file '%s': %s", path, strerror(errno));
+        log_message(error_msg);
+        exit(EXIT_FAILURE);
+    }
+
+    char log_msg[512];
+    snprintf(log_msg, sizeof(log_msg), "Recording to capture file: %s", path);
+    log_message(log_msg);
+    return file;
+}
+
+int main(int argc, char *argv[]) {
+    const char *host = argc > 1 ? argv[1] : DEFAULT_HOST;
+    const char *capture_path = argc > 2 ? argv[2] : NULL;
+    int sock = 0;
+    struct sockaddr_in serv_addr;
+    char buffer[BUFFER_SIZE];
+
+    install_signal_handlers();
+
+    create_log_file();
+    log_message("Program started");
+
+    if ((sock = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
+        log_message("Socket creation error");
+        return -1;
+    }
+
+    serv_addr.sin_family = AF_INET;
+    serv_addr.sin_port = htons(PORT);
+
+    if (inet_pton(AF_INET, host, &serv_addr.sin_addr) <= 0) {
+        log_message("Invalid address/ Address not supported");
+        return -1;
+    }
+
+    int retry_count = 0;
+    while (retry_count < MAX_RETRIES) {
+        if (connect(sock, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0) {
+            char error_msg[512];
+            snprintf(error_msg, sizeof(error_msg), "Connection Failed. Retrying... (%d/%d)", retry_count + 1, MAX_RETRIES);
+            log_message(error_msg);
+            usleep(RETRY_DELAY);
+            retry_count++;
+        } else {
+            break;
+        }
+    }
+
+    if (retry_count == MAX_RETRIES) {
+        log_message("Max retries reached. Exiting.");
+        return -1;
+    }
+
+    log_message("Connected to server. Starting capture...");
+
+    // Opened only once connected, so a failed run leaves no empty capture behind
+    FILE *capture_file = open_capture_file(capture_path);
+    int write_failed = 0;
+
+    long long bytes_captured = 0;
+    long long lines_captured = 0;
+    long records_captured = 0;
+    time_t start_time_t, current_time_t, last_print_t;
+    time(&start_time_t);
+    last_print_t = start_time_t;
+
+    while (keep_running) {
+        int valread = recv(sock, buffer, BUFFER_SIZE, 0);
+        if (valread <= 0) {
+            if (valread == 0) {
+                log_message("Server closed the connection");
+            } else if (errno != EINTR) {
+                log_message("recv failed");
+            }
+            break;
+        }
+
+        // Timestamp as close to the recv() as possible, before any file I/O
+        struct timespec mono, wall;
+        clock_gettime(CLOCK_MONOTONIC, &mono);
+        clock_gettime(CLOCK_REALTIME, &wall);
+        double arrival = mono.tv_sec + mono.tv_nsec / 1e9;
+        double wall_time = wall.tv_sec + wall.tv_nsec / 1e9;
+        uint32_t length = (uint32_t)valread;
+
+        if (fwrite(&arrival, sizeof(double), 1, capture_file) != 1 ||
+            fwrite(&wall_time, sizeof(double), 1, capture_file) != 1 ||
+            fwrite(&length, sizeof(uint32_t), 1, capture_file) != 1 ||
+            fwrite(buffer, 1, length, capture_file) != length) {
+            char error_msg[512];
+            snprintf(error_msg, sizeof(error_msg), "Error writing capture file: %s. Stopping capture.", strerror(errno));
+            log_message(error_msg);
+            write_failed = 1;
+            break;
+        }
+
+        bytes_captured += valread;
+        records_captured++;
+        for (int i = 0; i < valread; i++) {
+            if (buffer[i] == '\n') lines_captured++;
+        }
+
+        time(&current_time_t);
+        if (difftime(current_time_t, last_print_t) >= PRINT_INTERVAL) {
+            double elapsed_time = difftime(current_time_t, start_time_t);
+            char status_msg[512];
+            snprintf(status_msg, sizeof(status_msg), "Bytes: %lld | Lines: %lld | Elapsed time: %.0f s | Avg rate: %.2f lines/s",
+                     bytes_captured, lines_captured, elapsed_time, lines_captured / elapsed_time);
+            log_message(status_msg);
+            last_print_t = current_time_t;
+        }
+    }
+
+    // fclose flushes the last buffered records, which can fail on a full disk too
+    if (fclose(capture_file) != 0 && !write_failed) {
+        char error_msg[512];
+        snprintf(error_msg, sizeof(error_msg), "Error writing capture file: %s", strerror(errno));
+        log_message(error_msg);
+        write_failed = 1;
+    }
+    close(sock);
+
+    char final_msg[512];
+    snprintf(final_msg, sizeof(final_msg), "Capture %s. %ld records, %lld bytes, %lld lines",
+             write_failed ? "incomplete (write error)" : "complete",
+             records_captured, bytes_captured, lines_captured);
+    log_message(final_msg);
+
+    fclose(log_file);
+    return write_failed ? 1 : 0;
+}
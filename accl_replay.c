@@ -0,0 +1,695 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <math.h>
+#include <limits.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+#include <errno.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <poll.h>
+#ifdef __linux__
+#include <linux/sockios.h>
+#endif
+
+#define PORT 65432
+#define SENSOR_RATE 1000 // Lines per second sent by one accl_tx
+#define MAX_RECEIVERS 64
+#define REPORT_INTERVAL 1.0 // Print receiver status every second
+#define LINE_SIZE 128
+#define CAPTURE_MAGIC "ACCLCAP2"
+#define MAX_RECORD_SIZE 4096 // accl_cap never records more than its BUFFER_SIZE per recv()
+#define SAMPLE_SIZE (4 * sizeof(double)) // One accl_rx .bin record: timestamp, x, y, z
+#define MAX_SAMPLE_GAP 10.0 // Larger timestamp steps in a .bin chunk mean it is not one
+
+/*
+ * Replays a recorded stream (accl_cap .cap files) or a stream synthesised
+ * from accl_rx .bin chunks to one or more accl_rx receivers, acting as the
+ * Raspberry Pi server on port 65432.
+ *
+ * The whole stream is held in memory as one byte buffer plus a schedule of
+ * (stream time, end byte) segments; loops are appended to it at load time, so
+ * .bin loops carry continuing timestamps while .cap loops repeat the original
+ * bytes. Every receiver keeps its own position in
+ * the buffer and is written with non-blocking sends, so one slow receiver
+ * never holds back the others. A receiver's backlog is the data that is due
+ * but not yet accepted by its socket plus what is still queued in the
+ * sender's kernel buffer; if that grows, the receiver is below the offered
+ * rate and its ingest rate is the ceiling.
+ */
+
+typedef struct {
+    char *data;
+    size_t size;
+    size_t capacity;
+    double *seg_time;   // Stream time (s, from start) at which a segment is due
+    size_t *seg_end;    // Byte offset one past the end of the segment
+    size_t nseg;
+    size_t seg_capacity;
+    long long lines;
+    double bin_first;   // First and last .bin sample timestamps, for loop shifts
+    double bin_last;
+    long long bin_samples;
+} stream_t;
+
+typedef struct {
+    int fd;
+    int connected;
+    size_t pos;               // Bytes handed to the socket
+    size_t last_consumed;
+    size_t window_consumed;   // Bytes consumed while this receiver still had data to take
+    double window_time;
+    int window_closed;
+    int finished;             // Everything sent and acknowledged
+    double finish_time;
+    double peak_rate;
+    // Running least-squares fit of backlog (samples) against time
+    double n, sum_t, sum_b, sum_tb, sum_tt;
+} receiver_t;
+
+volatile sig_atomic_t keep_running = 1;
+FILE *log_file = NULL;
+
+void signal_handler(int signum) {
+    keep_running = 0;
+}
+
+void log_message(const char *message) {
+    time_t now;
+    char timestamp[64];
+    time(&now);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", localtime(&now));
+    fprintf(stderr, "[%s] %s\n", timestamp, message);
+    if (log_file) {
+        fprintf(log_file, "[%s] %s\n", timestamp, message);
+        fflush(log_file);
+    }
+}
+
+void create_log_file() {
+    char log_folder[256] = "logs";
+    char log_filename[512];
+    char full_path[768];
+    time_t now = time(NULL);
+    struct tm *t = localtime(&now);
+
+    mkdir(log_folder, 0777);
+
+    strftime(log_filename, sizeof(log_filename), "%Y-%m-%d_%H-%M-%S_accl_replay.log", t);
+    snprintf(full_path, sizeof(full_path), "%s/%s", log_folder, log_filename);
+
+    log_file = fopen(full_path, "w");
+    if (log_file == NULL) {
+        fprintf(stderr, "Error creating log file '%s': %s\n", full_path, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+}
+
+double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void stream_append(stream_t *s, double t, const char *bytes, size_t len) {
+    if (s->size + len > s->capacity) {
+        while (s->size + len > s->capacity) {
+            s->capacity = s->capacity ? s->capacity * 2 : 1 << 20;
+        }
+        s->data = realloc(s->data, s->capacity);
+    }
+    if (s->nseg == s->seg_capacity) {
+        s->seg_capacity = s->seg_capacity ? s->seg_capacity * 2 : 4096;
+        s->seg_time = realloc(s->seg_time, s->seg_capacity * sizeof(double));
+        s->seg_end = realloc(s->seg_end, s->seg_capacity * sizeof(size_t));
+    }
+    if (s->data == NULL || s->seg_time == NULL || s->seg_end == NULL) {
+        log_message("Out of memory while loading stream");
+        exit(EXIT_FAILURE);
+    }
+
+    // Keep the schedule monotonic even if the source clock stepped backwards
+    if (s->nseg > 0 && t < s->seg_time[s->nseg - 1]) {
+        t = s->seg_time[s->nseg - 1];
+    }
+
+    memcpy(s->data + s->size, bytes, len);
+    s->size += len;
+    for (size_t i = 0; i < len; i++) {
+        if (bytes[i] == '\n') s->lines++;
+    }
+    s->seg_time[s->nseg] = t;
+    s->seg_end[s->nseg] = s->size;
+    s->nseg++;
+}
+
+double stream_duration(const stream_t *s) {
+    return s->nseg ? s->seg_time[s->nseg - 1] : 0;
+}
+
+// Stream time for the first segment of the next file or loop: one mean
+// inter-arrival gap after the last segment, so no interval is dropped
+double stream_next_start(const stream_t *s) {
+    if (s->nseg == 0) return 0;
+    if (s->nseg == 1) return 1.0 / SENSOR_RATE;
+    return stream_duration(s) * s->nseg / (s->nseg - 1);
+}
+
+int is_capture(const char *path) {
+    FILE *file = fopen(path, "rb");
+    char magic[8];
+    int match = 0;
+
+    if (file != NULL) {
+        match = fread(magic, 1, 8, file) == 8 && memcmp(magic, CAPTURE_MAGIC, 8) == 0;
+        fclose(file);
+    }
+    return match;
+}
+
+int load_capture(stream_t *s, const char *path) {
+    FILE *file = fopen(path, "rb");
+    char magic[8];
+    char msg[512];
+
+    if (file == NULL) {
+        snprintf(msg, sizeof(msg), "Error opening capture '%s': %s", path, strerror(errno));
+        log_message(msg);
+        return -1;
+    }
+    if (fread(magic, 1, 8, file) != 8 || memcmp(magic, CAPTURE_MAGIC, 8) != 0) {
+        snprintf(msg, sizeof(msg), "Not an accl_cap capture file: %s", path);
+        log_message(msg);
+        fclose(file);
+        return -1;
+    }
+
+    double base = stream_next_start(s);
+    double first = -1;
+    double arrival, wall_time;
+    uint32_t length;
+    char payload[MAX_RECORD_SIZE];
+
+    while (fread(&arrival, sizeof(double), 1, file) == 1 &&
+           fread(&wall_time, sizeof(double), 1, file) == 1 &&
+           fread(&length, sizeof(uint32_t), 1, file) == 1) {
+        if (length == 0 || length > MAX_RECORD_SIZE) {
+            snprintf(msg, sizeof(msg), "Corrupt capture '%s': record length %u out of range", path, length);
+            log_message(msg);
+            fclose(file);
+            return -1;
+        }
+        if (fread(payload, 1, length, file) != length) {
+            log_message("Warning: truncated record at end of capture, ignoring it");
+            break;
+        }
+        if (first < 0) first = arrival;
+        stream_append(s, base + (arrival - first), payload, length);
+    }
+
+    fclose(file);
+    return 0;
+}
+
+// Loads an accl_rx .bin chunk, shifting its sample timestamps by ts_shift
+int load_bin(stream_t *s, const char *path, double ts_shift) {
+    FILE *file = fopen(path, "rb");
+    struct stat st;
+    char msg[512];
+    char line[LINE_SIZE];
+    double sample[4];
+
+    if (file == NULL) {
+        snprintf(msg, sizeof(msg), "Error opening chunk '%s': %s", path, strerror(errno));
+        log_message(msg);
+        return -1;
+    }
+    if (fstat(fileno(file), &st) < 0 || st.st_size == 0 || st.st_size % SAMPLE_SIZE != 0) {
+        snprintf(msg, sizeof(msg), "Not an accl_rx .bin chunk or accl_cap capture: %s", path);
+        log_message(msg);
+        fclose(file);
+        return -1;
+    }
+
+    double base = stream_next_start(s);
+    double first = -1;
+    double prev = 0;
+    long long index = 0;
+
+    // Re-create the text lines accl_tx sends, paced by the recorded timestamps
+    while (fread(sample, sizeof(double), 4, file) == 4) {
+        if (!isfinite(sample[0]) || sample[0] <= 0 ||
+            (first >= 0 && fabs(sample[0] - prev) > MAX_SAMPLE_GAP)) {
+            snprintf(msg, sizeof(msg), "Corrupt chunk '%s': implausible timestamp at sample %lld", path, index);
+            log_message(msg);
+            fclose(file);
+            return -1;
+        }
+        if (first < 0) first = sample[0];
+        prev = sample[0];
+        index++;
+
+        if (s->bin_samples == 0) s->bin_first = sample[0];
+        s->bin_last = sample[0];
+        s->bin_samples++;
+
+        double ts = sample[0] + ts_shift;
+        long sec = (long)floor(ts);
+        long nsec = lround((ts - sec) * 1e9);
+        if (nsec >= 1000000000) {
+            sec++;
+            nsec -= 1000000000;
+        }
+        int len = snprintf(line, sizeof(line), "%ld.%09ld,%.6f,%.6f,%.6f\n",
+                           sec, nsec, sample[1], sample[2], sample[3]);
+        stream_append(s, base + (sample[0] - first), line, len);
+    }
+
+    fclose(file);
+    return 0;
+}
+
+// Loads every input file once; .bin timestamps are shifted by ts_shift
+int load_inputs(stream_t *s, char **paths, int count, double ts_shift) {
+    for (int i = 0; i < count; i++) {
+        int rc = is_capture(paths[i]) ? load_capture(s, paths[i])
+                                      : load_bin(s, paths[i], ts_shift);
+        if (rc < 0) return -1;
+    }
+    return 0;
+}
+
+// Bytes written to the socket that the peer has not acknowledged yet
+long socket_unsent(int fd) {
+    int queued = 0;
+#if defined(SIOCOUTQ)
+    if (ioctl(fd, SIOCOUTQ, &queued) < 0) queued = 0;
+#elif defined(SO_NWRITE)
+    socklen_t len = sizeof(queued);
+    if (getsockopt(fd, SOL_SOCKET, SO_NWRITE, &queued, &len) < 0) queued = 0;
+#endif
+    return queued;
+}
+
+int setup_socket(int port) {
+    int server_fd;
+    struct sockaddr_in address;
+    int opt = 1;
+
+    if ((server_fd = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
+        log_message("Socket creation failed");
+        return -1;
+    }
+
+    if (setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt))) {
+        log_message("Setsockopt failed");
+        return -1;
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = INADDR_ANY;
+    address.sin_port = htons(port);
+
+    if (bind(server_fd, (struct sockaddr *)&address, sizeof(address)) < 0) {
+        log_message("Bind failed");
+        return -1;
+    }
+
+    if (listen(server_fd, MAX_RECEIVERS) < 0) {
+        log_message("Listen failed");
+        return -1;
+    }
+
+    return server_fd;
+}
+
+// Parses a whole-string integer in [min, max]; returns -1 on anything else
+int parse_long(const char *str, long min, long max, long *value) {
+    char *end;
+    errno = 0;
+    long v = strtol(str, &end, 10);
+    if (errno != 0 || end == str || *end != '\0' || v < min || v > max) return -1;
+    *value = v;
+    return 0;
+}
+
+// Parses a replay speed: a positive multiplier, or "max" (returned as 0)
+int parse_speed(const char *str, double *speed) {
+    char *end;
+    if (strcmp(str, "max") == 0) {
+        *speed = 0;
+        return 0;
+    }
+    errno = 0;
+    double v = strtod(str, &end);
+    if (errno != 0 || end == str || *end != '\0' || !isfinite(v) || v <= 0) return -1;
+    *speed = v;
+    return 0;
+}
+
+void install_signal_handlers() {
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = signal_handler;
+    sigemptyset(&sa.sa_mask);
+    // No SA_RESTART, so a blocking accept() returns EINTR on Ctrl-C
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+}
+
+void drop_receiver(receiver_t *r, int id, const char *reason) {
+    char msg[512];
+    snprintf(msg, sizeof(msg), "Receiver %d disconnected: %s", id, reason);
+    log_message(msg);
+    close(r->fd);
+    r->connected = 0;
+    r->window_closed = 1;
+}
+
+// Receivers never send anything, so readable means closed, reset or stray input
+void check_receiver(receiver_t *r, int id, short revents) {
+    char discard[256];
+
+    if (revents & (POLLERR | POLLHUP)) {
+        int err = 0;
+        socklen_t len = sizeof(err);
+        getsockopt(r->fd, SOL_SOCKET, SO_ERROR, &err, &len);
+        drop_receiver(r, id, err ? strerror(err) : "connection closed by peer");
+        return;
+    }
+    if (revents & POLLIN) {
+        ssize_t n = recv(r->fd, discard, sizeof(discard), 0);
+        if (n == 0) {
+            drop_receiver(r, id, "connection closed by peer");
+        } else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            drop_receiver(r, id, strerror(errno));
+        }
+    }
+}
+
+void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-s speed] [-n receivers] [-l loops] [-p port] file...\n"
+            "  file       .cap capture from accl_cap, or .bin chunk from accl_rx\n"
+            "  -s speed   replay speed multiplier, or 'max' for no pacing (default 1)\n"
+            "  -n count   receivers to wait for before starting (default 1)\n"
+            "  -l loops   play the stream this many times (default 1); .bin loops continue\n"
+            "             the timestamps, .cap loops repeat the original bytes\n"
+            "  -p port    port to listen on (default %d)\n",
+            prog, PORT);
+}
+
+int main(int argc, char *argv[]) {
+    double speed = 1.0;   // 0 means as fast as the receivers accept
+    long num_receivers = 1;
+    long loops = 1;
+    long port = PORT;
+    int opt, bad = 0;
+    char msg[512];
+
+    while ((opt = getopt(argc, argv, "s:n:l:p:h")) != -1) {
+        switch (opt) {
+            case 's':
+                bad |= parse_speed(optarg, &speed);
+                break;
+            case 'n':
+                bad |= parse_long(optarg, 1, MAX_RECEIVERS, &num_receivers);
+                break;
+            case 'l':
+                bad |= parse_long(optarg, 1, INT_MAX, &loops);
+                break;
+            case 'p':
+                bad |= parse_long(optarg, 1, 65535, &port);
+                break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (bad || optind >= argc) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    install_signal_handlers();
+
+    create_log_file();
+    log_message("Program started");
+
+    stream_t stream = {0};
+    if (load_inputs(&stream, argv + optind, argc - optind, 0) < 0) return 1;
+    if (stream.size == 0 || stream.lines == 0) {
+        log_message("No data to replay");
+        return 1;
+    }
+
+    // Later loops continue the .bin timestamps one sample period after the
+    // last one, so receivers see one long recording and rotate chunks as usual
+    double bin_span = stream.bin_last - stream.bin_first;
+    double bin_period = stream.bin_samples > 1 ? bin_span / (stream.bin_samples - 1) : 1.0 / SENSOR_RATE;
+    for (long loop = 1; loop < loops; loop++) {
+        if (load_inputs(&stream, argv + optind, argc - optind, loop * (bin_span + bin_period)) < 0) return 1;
+    }
+
+    double duration = stream_duration(&stream);
+    double bytes_per_line = (double)stream.size / stream.lines;
+    double stream_rate = duration > 0 ? stream.lines / duration : 0;
+    size_t total_bytes = stream.size;
+
+    snprintf(msg, sizeof(msg), "Loaded %lld lines, %zu bytes, %.1f s of stream in %ld loop(s) (%.1f lines/s, %.1f bytes/line)",
+             stream.lines, stream.size, duration, loops, stream_rate, bytes_per_line);
+    log_message(msg);
+
+    int server_fd = setup_socket(port);
+    if (server_fd < 0) return 1;
+
+    snprintf(msg, sizeof(msg), "Listening on port %ld. Waiting for %ld receiver(s)...", port, num_receivers);
+    log_message(msg);
+
+    receiver_t receivers[MAX_RECEIVERS] = {{0}};
+    int accepted = 0;
+    while (keep_running && accepted < num_receivers) {
+        struct sockaddr_in address;
+        socklen_t addrlen = sizeof(address);
+        int fd = accept(server_fd, (struct sockaddr *)&address, &addrlen);
+        if (fd < 0) {
+            if (errno != EINTR) log_message("Accept failed");
+            continue;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        receivers[accepted].fd = fd;
+        receivers[accepted].connected = 1;
+        snprintf(msg, sizeof(msg), "Receiver %d connected from %s", accepted, inet_ntoa(address.sin_addr));
+        log_message(msg);
+        accepted++;
+    }
+    close(server_fd);
+
+    if (!keep_running) {
+        log_message("Interrupted while waiting for receivers. Exiting.");
+        for (int i = 0; i < accepted; i++) close(receivers[i].fd);
+        fclose(log_file);
+        return 0;
+    }
+
+    if (speed > 0) {
+        snprintf(msg, sizeof(msg), "Starting replay at %.2fx (offered %.1f lines/s per receiver)", speed, stream_rate * speed);
+    } else {
+        snprintf(msg, sizeof(msg), "Starting replay at max speed");
+    }
+    log_message(msg);
+
+    double start = now_seconds();
+    double last_report = start;
+    size_t due = 0;          // Bytes every receiver should have been sent by now
+    size_t last_due = 0;
+    size_t cursor = 0;       // Next segment in the schedule
+
+    while (keep_running) {
+        double now = now_seconds();
+        double elapsed = now - start;
+
+        // Advance the schedule to the current stream time
+        if (speed == 0) {
+            due = total_bytes;
+            cursor = stream.nseg;
+        } else {
+            double stream_time = elapsed * speed;
+            while (cursor < stream.nseg && stream.seg_time[cursor] <= stream_time) {
+                due = stream.seg_end[cursor];
+                cursor++;
+            }
+        }
+
+        // Hand each receiver as much of its due data as its socket accepts
+        struct pollfd fds[MAX_RECEIVERS];
+        int owner[MAX_RECEIVERS];
+        int nfds = 0, active = 0, pending = 0, draining = 0;
+        for (int i = 0; i < accepted; i++) {
+            receiver_t *r = &receivers[i];
+            if (!r->connected) continue;
+
+            while (r->pos < due) {
+                ssize_t sent = send(r->fd, stream.data + r->pos, due - r->pos, 0);
+                if (sent < 0) {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) break;
+                    drop_receiver(r, i, strerror(errno));
+                    break;
+                }
+                r->pos += sent;
+            }
+            if (!r->connected) continue;
+            active++;
+
+            if (r->pos < due) {
+                pending++;
+            } else if (r->pos == total_bytes) {
+                if (socket_unsent(r->fd) > 0) {
+                    draining++;
+                } else if (!r->finished) {
+                    r->finished = 1;
+                    r->finish_time = now;
+                }
+            }
+
+            // Poll every receiver for input too, so a peer that closes or
+            // resets while it has nothing left to send is still noticed
+            fds[nfds].fd = r->fd;
+            fds[nfds].events = POLLIN | (r->pos < due ? POLLOUT : 0);
+            owner[nfds] = i;
+            nfds++;
+        }
+
+        // Periodic report of ingest rate and backlog per receiver. A paced run
+        // also reports the moment its schedule runs out, so the summary window
+        // stops there and does not include the drain afterwards.
+        int schedule_done = speed > 0 && cursor == stream.nseg && last_due < total_bytes;
+        if (now - last_report >= REPORT_INTERVAL || active == 0 || schedule_done ||
+            (cursor == stream.nseg && pending == 0 && draining == 0)) {
+            double dt = now - last_report;
+            int offering = speed == 0 || last_due < total_bytes;
+            if (dt > 0) {
+                double offered = (due - last_due) / bytes_per_line / dt;
+                for (int i = 0; i < accepted; i++) {
+                    receiver_t *r = &receivers[i];
+                    if (!r->connected) continue;
+
+                    long unsent = socket_unsent(r->fd);
+                    size_t consumed = r->pos - unsent;
+                    double backlog = ((due - r->pos) + unsent) / bytes_per_line;
+
+                    // A receiver's window ends once it has taken everything,
+                    // so a fast receiver is not averaged over a slower one's run
+                    double window_end = r->finished && !r->window_closed ? r->finish_time : now;
+                    double rdt = window_end - last_report;
+                    double rate = rdt > 0 ? (consumed - r->last_consumed) / bytes_per_line / rdt : 0;
+
+                    if (offering && !r->window_closed) {
+                        r->window_time += rdt;
+                        if (r->finished) r->window_closed = 1;
+                        r->window_consumed += consumed - r->last_consumed;
+                        if (rate > r->peak_rate) r->peak_rate = rate;
+                        r->n += 1;
+                        r->sum_t += elapsed;
+                        r->sum_b += backlog;
+                        r->sum_tb += elapsed * backlog;
+                        r->sum_tt += elapsed * elapsed;
+                    }
+                    r->last_consumed = consumed;
+
+                    char offered_str[32];
+                    if (speed > 0) {
+                        snprintf(offered_str, sizeof(offered_str), "%.0f lines/s", offered);
+                    } else {
+                        snprintf(offered_str, sizeof(offered_str), "max");
+                    }
+                    snprintf(msg, sizeof(msg), "rx%d | t=%.1f s | offered %s | ingest %.0f lines/s | backlog %.0f lines (%.2f s of stream)",
+                             i, elapsed, offered_str, rate, backlog, stream_rate > 0 ? backlog / stream_rate : 0);
+                    log_message(msg);
+                }
+            }
+            last_report = now;
+            last_due = due;
+        }
+
+        if (active == 0) {
+            log_message("All receivers disconnected");
+            break;
+        }
+        if (cursor == stream.nseg && pending == 0 && draining == 0) {
+            log_message("Replay complete, all receivers drained");
+            break;
+        }
+
+        // Sleep until a socket drains, the next segment is due, or the next report
+        double wait = last_report + REPORT_INTERVAL - now;
+        if (draining > 0 && wait > 0.01) wait = 0.01;
+        if (speed > 0 && cursor < stream.nseg) {
+            double next_due = stream.seg_time[cursor] / speed - elapsed;
+            if (next_due < wait) wait = next_due;
+        }
+        int timeout_ms = wait > 0 ? (int)ceil(wait * 1000) : 0;
+        if (poll(fds, nfds, timeout_ms) > 0) {
+            for (int k = 0; k < nfds; k++) {
+                if (fds[k].revents & (POLLIN | POLLERR | POLLHUP)) {
+                    check_receiver(&receivers[owner[k]], owner[k], fds[k].revents);
+                }
+            }
+        }
+    }
+
+    // Summary: sustained ingest is the mean over each receiver's own window
+    // (data still offered and not yet all taken), backlog growth is the slope
+    // of a least-squares fit through the backlog reported over that window.
+    // At max speed everything is offered up front, so the whole run is
+    // receiver-limited and growth is meaningless.
+    double elapsed = now_seconds() - start;
+    double total_rate = 0;
+    log_message("---- Replay summary ----");
+    if (speed > 0) {
+        snprintf(msg, sizeof(msg), "Duration %.1f s | %d receiver(s) | %.2fx, offered %.0f lines/s per receiver",
+                 elapsed, accepted, speed, stream_rate * speed);
+    } else {
+        snprintf(msg, sizeof(msg), "Duration %.1f s | %d receiver(s) | max speed, unpaced", elapsed, accepted);
+    }
+    log_message(msg);
+
+    for (int i = 0; i < accepted; i++) {
+        receiver_t *r = &receivers[i];
+        double rate = r->window_time > 0 ? r->window_consumed / bytes_per_line / r->window_time : 0;
+        total_rate += rate;
+
+        if (speed > 0) {
+            double denom = r->n * r->sum_tt - r->sum_t * r->sum_t;
+            double growth = r->n >= 3 && denom > 0 ? (r->n * r->sum_tb - r->sum_t * r->sum_b) / denom : 0;
+            snprintf(msg, sizeof(msg), "rx%d | sustained ingest %.0f lines/s | peak %.0f lines/s | backlog growth %+.1f lines/s%s",
+                     i, rate, r->peak_rate, growth,
+                     growth > 0.01 * rate ? " (falling behind: ingest is the ceiling)" : "");
+        } else {
+            snprintf(msg, sizeof(msg), "rx%d | ingest ceiling %.0f lines/s | peak %.0f lines/s",
+                     i, rate, r->peak_rate);
+        }
+        log_message(msg);
+
+        if (r->connected) close(r->fd);
+    }
+
+    snprintf(msg, sizeof(msg), "Aggregate ingest %.0f lines/s (%.1f sensors at %d lines/s)",
+             total_rate, total_rate / SENSOR_RATE, SENSOR_RATE);
+    log_message(msg);
+
+    free(stream.data);
+    free(stream.seg_time);
+    free(stream.seg_end);
+    fclose(log_file);
+    return 0;
+}
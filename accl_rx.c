@@ -17,6 +17,7 @@
 #define PRINT_INTERVAL 10000 // Print status every 10,000 samples
 #define MAX_RETRIES 5
 #define RETRY_DELAY 1000000 // 1 second in microseconds
+#define DEFAULT_HOST "192.168.40.61"
 
 volatile sig_atomic_t keep_running = 1;
 FILE *log_file = NULL;
@@ -88,7 +89,8 @@ FILE* open_new_file(const char *output_folder, int chunk_number, double start_ti
     return file;
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+    const char *host = argc > 1 ? argv[1] : DEFAULT_HOST;
     int sock = 0;
     struct sockaddr_in serv_addr;
     char buffer[BUFFER_SIZE] = {0};
@@ -111,7 +113,7 @@ int main() {
     serv_addr.sin_family = AF_INET;
     serv_addr.sin_port = htons(PORT);
     
-    if (inet_pton(AF_INET, "192.168.40.61", &serv_addr.sin_addr) <= 0) {
+    if (inet_pton(AF_INET, host, &serv_addr.sin_addr) <= 0) {
         log_message("Invalid address/ Address not supported");
         return -1;
     }